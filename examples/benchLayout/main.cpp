@@ -0,0 +1,142 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+using namespace std;
+
+// Standalone benchmark of voxel memory layouts for oblique beams.
+// It does not link libFred: the library has no layout switch, so the access pattern of transport
+// is reproduced here. CT stopping power is read and energy is deposited in a scorer grid at every
+// step of pencil rays crossing a cubic phantom, for the 12 gantry angles of the example02 loop.
+//
+// Layouts:
+//   linear  x fastest (current libFred storage)
+//   brick   8x8x8 bricks, linear inside each brick and bricks in linear order
+//   morton  Z-order (bit-interleaved i,j,k)
+//
+// The scorer is converted back to linear order at export time and checked to be bitwise
+// identical to the linear-layout result.
+
+const int B=8; // brick side
+
+struct Linear {
+	int n;
+	size_t size() const {return 1UL*n*n*n;}
+	size_t operator()(int i,int j,int k) const {return i+n*(j+(size_t)n*k);}
+};
+
+struct Brick {
+	int n,nb;
+	Brick(int n_):n(n_),nb((n_+B-1)/B){}
+	size_t size() const {return 1UL*nb*nb*nb*B*B*B;}
+	size_t operator()(int i,int j,int k) const {
+		size_t ib=(i/B)+nb*((j/B)+(size_t)nb*(k/B));
+		return ib*B*B*B + (i%B)+B*((j%B)+B*(k%B));
+	}
+};
+
+static inline uint32_t spread3(uint32_t x){ // 10 bits -> every third bit
+	x&=0x3ff;
+	x=(x|(x<<16))&0x030000FF;
+	x=(x|(x<< 8))&0x0300F00F;
+	x=(x|(x<< 4))&0x030C30C3;
+	x=(x|(x<< 2))&0x09249249;
+	return x;
+}
+struct Morton {
+	int n,np2;
+	Morton(int n_):n(n_),np2(1){while(np2<n) np2*=2;}
+	size_t size() const {return 1UL*np2*np2*np2;}
+	size_t operator()(int i,int j,int k) const {return spread3(i)|(spread3(j)<<1)|(spread3(k)<<2);}
+};
+
+static inline uint64_t splitmix64(uint64_t &s){
+	uint64_t z=(s+=0x9E3779B97F4A7C15ULL);
+	z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+	z=(z^(z>>27))*0x94D049BB133111EBULL;
+	return z^(z>>31);
+}
+static inline float urand(uint64_t &s){return (splitmix64(s)>>40)*(1.f/16777216.f);}
+
+const int Npos=12;
+
+// tracks nrays rays per gantry angle; returns per-angle times in t[] and number of steps in nsteps[]
+template<class L> void gantry(const L &idx,int n,int nrays,const vector<float> &ct,vector<float> &dose,double t[Npos],long nsteps[Npos]){
+	const float h=0.5f; // step in voxel units
+	for(int ipos=0;ipos<Npos;ipos++){
+		float alpha=2*M_PI/Npos*ipos;
+		float ca=cos(alpha),sa=sin(alpha);
+		nsteps[ipos]=0;
+		auto t0=chrono::steady_clock::now();
+		for(int ir=0;ir<nrays;ir++){
+			uint64_t s=ipos*1000003ULL+ir; // same rays for every layout
+			// gaussian-like spot (sigma ~ n/16) around the phantom centre, beam along f=(0,sa,ca)
+			float dx=n/16.f*(urand(s)+urand(s)+urand(s)+urand(s)-2)*1.7f;
+			float du=n/16.f*(urand(s)+urand(s)+urand(s)+urand(s)-2)*1.7f;
+			float x=n/2.f+dx, y=n/2.f+du*ca-n*0.49f*sa, z=n/2.f-du*sa-n*0.49f*ca;
+			float vx=0.01f*(urand(s)-0.5f), vy=sa, vz=ca;
+			float E=0.8f*n; // residual range in voxels of unit stopping power
+			while(E>0){
+				int i=(int)x,j=(int)y,k=(int)z;
+				if(x<0 || y<0 || z<0 || i>=n || j>=n || k>=n) break;
+				size_t iv=idx(i,j,k);
+				float dE=h*ct[iv];
+				dose[iv]+=dE;
+				E-=dE;
+				x+=h*vx; y+=h*vy; z+=h*vz;
+				nsteps[ipos]++;
+			}
+		}
+		t[ipos]=chrono::duration<double>(chrono::steady_clock::now()-t0).count();
+	}
+}
+
+template<class L> void bench(const L &idx,int n,int nrays,vector<float> &exported,double t[Npos],long nsteps[Npos]){
+	vector<float> ct(idx.size(),0.f),dose(idx.size(),0.f);
+	for(int k=0;k<n;k++) for(int j=0;j<n;j++) for(int i=0;i<n;i++)
+		ct[idx(i,j,k)]=1+0.2f*sin(0.1f*i)*cos(0.07f*j)*sin(0.13f*k); // relative stopping power
+	gantry(idx,n,nrays,ct,dose,t,nsteps);
+	// export in linear order, as fredGetScorer_buffer / fredScorer_save would
+	exported.resize(1UL*n*n*n);
+	for(int k=0;k<n;k++) for(int j=0;j<n;j++) for(int i=0;i<n;i++)
+		exported[i+n*(j+(size_t)n*k)]=dose[idx(i,j,k)];
+}
+
+int main(int argc, char *argv[]){
+
+int n     = argc>1 ? atoi(argv[1]) : 256;
+int nrays = argc>2 ? atoi(argv[2]) : 10000;
+if(n<8 || n>1024) {cerr<<"Error: grid size must be in [8,1024]"<<endl; return 1;}
+
+cout<<"grid "<<n<<"^3, "<<nrays<<" rays per angle, "<<Npos<<" gantry angles"<<endl;
+
+const char *names[3]={"linear","brick","morton"};
+double t[3][Npos];
+long nsteps[Npos]; // identical rays and arithmetic: same step count for every layout
+vector<float> ref,out;
+bool identical[3]={true,true,true};
+
+bench(Linear{n},n,nrays,ref,t[0],nsteps);
+bench(Brick(n),n,nrays,out,t[1],nsteps);
+identical[1] = memcmp(ref.data(),out.data(),ref.size()*sizeof(float))==0;
+bench(Morton(n),n,nrays,out,t[2],nsteps);
+identical[2] = memcmp(ref.data(),out.data(),ref.size()*sizeof(float))==0;
+
+cout<<"ns per step   angle   linear    brick   morton"<<endl;
+double tot[3]={0,0,0};
+for(int ipos=0;ipos<Npos;ipos++){
+	double nsPerStep=1e9/nsteps[ipos];
+	printf("              %5.0f  %7.2f  %7.2f  %7.2f\n",360./Npos*ipos,t[0][ipos]*nsPerStep,t[1][ipos]*nsPerStep,t[2][ipos]*nsPerStep);
+	for(int l=0;l<3;l++) tot[l]+=t[l][ipos];
+}
+for(int l=0;l<3;l++){
+	cout<<names[l]<<": total "<<tot[l]<<" s, speedup vs linear "<<tot[0]/tot[l]
+	    <<", exported dose "<<(identical[l] ? "bitwise identical" : "DIFFERENT")<<endl;
+}
+
+return 0;
+}
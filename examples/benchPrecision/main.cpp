@@ -0,0 +1,194 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+// Standalone benchmark of scorer accumulation precision policies.
+// It does not link libFred: the library does not expose a precision switch,
+// so the per-thread scorer replicas are reproduced here on a synthetic dose distribution
+// (pencil beam with Bragg-like depth dose plus a low-dose halo of tiny deposits
+// landing in voxels that already hold a large dose).
+//
+// Policies:
+//   float        per-thread float replicas, reduced in float
+//   float+flush  per-thread float scratch flushed every nflush histories into one shared double grid
+//   double       per-thread double replicas
+//   fixed-point  per-thread 64-bit integer replicas (scale 2^-40), deterministic under any reduction order
+//
+// For each policy: throughput, memory (per voxel and measured peak RSS), relative error of the total
+// energy with respect to an exact reference, and bitwise reproducibility of the exported float grid
+// between a 1-thread and an N-thread run.
+
+const int nx=64,ny=64,nz=256;
+const size_t NVOX=1UL*nx*ny*nz;
+const double FIXED_SCALE=1099511627776.0; // 2^40
+const int nflush=1000;
+
+enum {POL_FLOAT,POL_FLUSH,POL_DOUBLE,POL_FIXED,NPOL};
+const char *names[NPOL]={"float","float+flush","double","fixed-point"};
+
+// counter-based generator: the deposits of a history depend only on its index, not on the thread running it
+static inline uint64_t splitmix64(uint64_t &s){
+	uint64_t z=(s+=0x9E3779B97F4A7C15ULL);
+	z=(z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+	z=(z^(z>>27))*0x94D049BB133111EBULL;
+	return z^(z>>31);
+}
+static inline double urand(uint64_t &s){return (splitmix64(s)>>11)*(1.0/9007199254740992.0);}
+
+// calls dep(ivox,edep) for every energy deposit of history ihist; returns total deposited energy
+template<class F> inline double history(long ihist,F dep){
+	uint64_t s=0x5EEDULL*(ihist+1);
+	int ix=nx/2+(int)lround(3*(urand(s)+urand(s)+urand(s)-1.5));
+	int iy=ny/2+(int)lround(3*(urand(s)+urand(s)+urand(s)-1.5));
+	double R=200+10*(urand(s)-0.5); // range in voxels
+	double etot=0;
+	for(int iz=0;iz<nz && iz<R;iz++){
+		double e=0.2/sqrt(R-iz+1.0);
+		dep(ix+nx*(iy+ny*(size_t)iz),e); etot+=e;
+		if(urand(s)<0.5){ // halo: tiny deposit near the core
+			int jx=ix+(int)(16*urand(s))-8, jy=iy+(int)(16*urand(s))-8;
+			double eh=1e-7*e;
+			dep(jx+nx*(jy+ny*(size_t)iz),eh); etot+=eh;
+		}
+	}
+	return etot;
+}
+
+struct Result {double seconds,relerr; long ndep; int reproducible;};
+
+// runs nhist histories on nthreads threads with the given policy; exports the grid as float (as fredGetScorer_buffer does)
+double run(int pol,long nhist,int nthreads,vector<float> &out,double &reference,long &ndep){
+	vector<vector<float> >   rf;
+	vector<vector<double> >  rd;
+	vector<vector<int64_t> > ri;
+	vector<double> shared;
+	mutex mtx;
+	if(pol==POL_FLOAT || pol==POL_FLUSH) rf.assign(nthreads,vector<float>(NVOX,0.f));
+	if(pol==POL_DOUBLE) rd.assign(nthreads,vector<double>(NVOX,0.));
+	if(pol==POL_FIXED)  ri.assign(nthreads,vector<int64_t>(NVOX,0));
+	if(pol==POL_FLUSH)  shared.assign(NVOX,0.);
+
+	vector<double> refs(nthreads,0.),comp(nthreads,0.);
+	vector<long> ndeps(nthreads,0);
+
+	auto worker=[&](int it){
+		long h0=nhist*it/nthreads, h1=nhist*(it+1)/nthreads;
+		double &ref=refs[it],&c=comp[it];
+		long &nd=ndeps[it];
+		for(long h=h0;h<h1;h++){
+			double e;
+			switch(pol){
+			case POL_FLOAT: case POL_FLUSH: {
+				float *g=rf[it].data();
+				e=history(h,[&](size_t i,double v){g[i]+=(float)v;nd++;});
+				if(pol==POL_FLUSH && ((h-h0+1)%nflush==0 || h==h1-1)){
+					lock_guard<mutex> lock(mtx);
+					for(size_t i=0;i<NVOX;i++) if(g[i]!=0.f) {shared[i]+=g[i]; g[i]=0.f;}
+				}
+				break;}
+			case POL_DOUBLE: {
+				double *g=rd[it].data();
+				e=history(h,[&](size_t i,double v){g[i]+=v;nd++;});
+				break;}
+			default: {
+				int64_t *g=ri[it].data();
+				e=history(h,[&](size_t i,double v){g[i]+=llround(v*FIXED_SCALE);nd++;});
+				break;}
+			}
+			// Kahan-summed reference of the deposited energy
+			double y=e-c, t=ref+y; c=(t-ref)-y; ref=t;
+		}
+	};
+
+	auto t0=chrono::steady_clock::now();
+	vector<thread> threads;
+	for(int it=0;it<nthreads;it++) threads.emplace_back(worker,it);
+	for(auto &t:threads) t.join();
+
+	// reduction of thread replicas
+	out.assign(NVOX,0.f);
+	for(size_t i=0;i<NVOX;i++){
+		switch(pol){
+		case POL_FLOAT: {float s=0; for(int it=0;it<nthreads;it++) s+=rf[it][i]; out[i]=s; break;}
+		case POL_FLUSH: out[i]=(float)shared[i]; break;
+		case POL_DOUBLE: {double s=0; for(int it=0;it<nthreads;it++) s+=rd[it][i]; out[i]=(float)s; break;}
+		default: {int64_t s=0; for(int it=0;it<nthreads;it++) s+=ri[it][i]; out[i]=(float)(s/FIXED_SCALE); break;}
+		}
+	}
+	auto t1=chrono::steady_clock::now();
+
+	reference=0; ndep=0;
+	for(int it=0;it<nthreads;it++) {reference+=refs[it]; ndep+=ndeps[it];}
+	return chrono::duration<double>(t1-t0).count();
+}
+
+double bytesPerVoxel(int pol,int nthreads){
+	switch(pol){
+	case POL_FLOAT:  return 4.*nthreads;
+	case POL_FLUSH:  return 4.*nthreads+8;
+	default:         return 8.*nthreads;
+	}
+}
+
+int main(int argc, char *argv[]){
+
+long nhist   = argc>1 ? atol(argv[1]) : 20000;
+int nthreads = argc>2 ? atoi(argv[2]) : max(4u,thread::hardware_concurrency());
+
+cout<<"grid "<<nx<<'x'<<ny<<'x'<<nz<<", "<<nhist<<" histories, "<<nthreads<<" threads"<<endl;
+
+for(int pol=0;pol<NPOL;pol++){
+	// each policy runs in a separate process so that its peak resident memory can be measured on its own;
+	// no threads exist in the parent when forking
+	int fd[2];
+	if(pipe(fd)) {perror("pipe"); return 1;}
+	pid_t pid=fork();
+	if(pid==0){
+		close(fd[0]);
+		vector<float> grid1,gridN;
+		double ref1,refN; long nd;
+		run(pol,nhist,1,grid1,ref1,nd);
+		Result r;
+		r.seconds=run(pol,nhist,nthreads,gridN,refN,nd);
+		r.ndep=nd;
+		double sum=0;
+		for(size_t i=0;i<NVOX;i++) sum+=gridN[i];
+		r.relerr=sum/refN-1;
+		r.reproducible = memcmp(grid1.data(),gridN.data(),NVOX*sizeof(float))==0;
+		if(write(fd[1],&r,sizeof(r))!=sizeof(r)) _exit(1);
+		_exit(0);
+	}
+	close(fd[1]);
+	Result r;
+	bool ok = read(fd[0],&r,sizeof(r))==sizeof(r);
+	close(fd[0]);
+	int status;
+	struct rusage ru;
+	wait4(pid,&status,0,&ru);
+	if(!ok || !WIFEXITED(status) || WEXITSTATUS(status)) {cerr<<names[pol]<<": run failed"<<endl; continue;}
+
+#ifdef __APPLE__
+	double rssMB = ru.ru_maxrss/1048576.; // bytes on macOS
+#else
+	double rssMB = ru.ru_maxrss/1024.;    // kilobytes on Linux
+#endif
+	cout<<names[pol]<<":"<<endl;
+	cout<<"   throughput       "<<r.ndep/r.seconds/1e6<<" Mdeposits/s"<<endl;
+	cout<<"   scorer memory    "<<bytesPerVoxel(pol,nthreads)<<" B/voxel = "<<bytesPerVoxel(pol,nthreads)*NVOX/1048576.<<" MB"<<endl;
+	cout<<"   peak RSS         "<<rssMB<<" MB"<<endl;
+	cout<<"   total rel. error "<<r.relerr<<endl;
+	cout<<"   1 vs "<<nthreads<<" threads   "<<(r.reproducible ? "bitwise identical" : "different")<<endl;
+}
+
+return 0;
+}
@@ -32,6 +32,10 @@ const char *getErrorMessage(int errCode) {
     return "Ill defined vector.";
   case FRED_REGION_ALREADY_DEFINED:
     return "Region already defined.";
+  case FRED_SCORER_NOT_FOUND:
+    return "Scorer not found.";
+  case FRED_SCORER_NOT_EVALUATED:
+    return "Scorer not evaluated.";
   default:
     printf("Error code: %d\n", errCode);
     return "Error code not implemented yet.";